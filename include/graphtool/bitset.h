@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <bit>
+
+namespace graphtool {
+
+/// Fixed-width bitset with word-parallel operations and fast iteration over all set bits.
+template<size_t N>
+class BitSet {
+public:
+    static_assert(N % 64 == 0);
+    static constexpr size_t Num_Words = N / 64;
+
+    /// The first @p n bits are set.
+    static BitSet first(size_t n) {
+        BitSet res;
+        for (size_t w = 0; w != Num_Words; ++w) {
+            if (n >= 64 * (w + 1)) {
+                res.words_[w] = ~uint64_t(0);
+            } else if (n > 64 * w) {
+                res.words_[w] = (uint64_t(1) << n % 64) - 1;
+            }
+        }
+        return res;
+    }
+
+    bool test(size_t i) const { return words_[i / 64] >> i % 64 & 1; }
+    BitSet& set(size_t i) {
+        words_[i / 64] |= uint64_t(1) << i % 64;
+        return *this;
+    }
+    BitSet& reset(size_t i) {
+        words_[i / 64] &= ~(uint64_t(1) << i % 64);
+        return *this;
+    }
+
+    /// Index of the highest set bit or `size_t(-1)` if none is set.
+    size_t last() const {
+        for (size_t w = Num_Words; w-- > 0;) {
+            if (words_[w]) return 64 * w + 63 - std::countl_zero(words_[w]);
+        }
+        return size_t(-1);
+    }
+
+    /// Invokes @p f for the index of each set bit in ascending order.
+    template<class F>
+    void for_each(F f) const {
+        for (size_t w = 0; w != Num_Words; ++w) {
+            for (auto bits = words_[w]; bits != 0; bits &= bits - 1) f(64 * w + std::countr_zero(bits));
+        }
+    }
+
+    /// @name Operators
+    ///@{
+    BitSet& operator&=(const BitSet& other) {
+        for (size_t w = 0; w != Num_Words; ++w) words_[w] &= other.words_[w];
+        return *this;
+    }
+    BitSet& operator|=(const BitSet& other) {
+        for (size_t w = 0; w != Num_Words; ++w) words_[w] |= other.words_[w];
+        return *this;
+    }
+    BitSet operator~() const {
+        BitSet res;
+        for (size_t w = 0; w != Num_Words; ++w) res.words_[w] = ~words_[w];
+        return res;
+    }
+    friend BitSet operator&(BitSet a, const BitSet& b) { return a &= b; }
+    friend BitSet operator|(BitSet a, const BitSet& b) { return a |= b; }
+    bool operator==(const BitSet&) const = default;
+    ///@}
+
+private:
+    std::array<uint64_t, Num_Words> words_ = {};
+};
+
+} // namespace graphtool
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "graphtool/graph.h"
+
+namespace graphtool {
+
+/// Strongly connected components (SCCs) of a Graph and the DAG they form.
+/// SCCs are in reverse topological order: each SCC only has edges to SCCs with smaller indices.
+class Condensation {
+public:
+    using Node = Graph::Node;
+
+    Condensation(const Graph&);
+
+    /// @name Getters
+    ///@{
+    Sym name() const { return name_; }
+    size_t num_nodes() const { return scc_.size(); }
+    size_t num_sccs() const { return offsets_.size() - 1; }
+    size_t scc(const Node* n) const { return scc_[n->id()]; }
+    bool trivial(size_t c) const { return !cyclic_[c]; } ///< A single Node without self-loop.
+    std::span<Node* const> members(size_t c) const {
+        return {members_.data() + first_[c], members_.data() + first_[c + 1]};
+    }
+    /// Successor SCCs without duplicates.
+    std::span<const size_t> succs(size_t c) const {
+        return {targets_.data() + offsets_[c], targets_.data() + offsets_[c + 1]};
+    }
+    ///@}
+
+    /// @name Classification
+    ///@{
+    size_t num_nontrivial() const { return num_nontrivial_; }
+    size_t num_unreachable() const { return num_unreachable_; } ///< Number of Node%s the entry can't reach.
+    size_t num_non_exiting() const { return num_non_exiting_; } ///< Number of Node%s that can't reach the exit.
+    bool reducible() const { return reducible_; }               ///< Has each loop reachable from entry one entry?
+    ///@}
+
+    void dump(std::ostream&) const;
+
+private:
+    /// Adjacency in CSR format: the targets of `v` are `targets[offsets[v]]` up to `targets[offsets[v + 1]]`.
+    struct CSR {
+        std::vector<size_t> offsets, targets;
+    };
+
+    static std::vector<size_t> pearce(const CSR& succs);
+    bool classify(size_t entry, const CSR& succs, const CSR& preds) const;
+
+    Sym name_;
+    std::vector<size_t> scc_;               ///< Node::id -> SCC.
+    std::vector<size_t> first_;             ///< SCC -> first member in Condensation::members_.
+    std::vector<Node*> members_;            ///< Grouped by SCC.
+    std::vector<size_t> offsets_, targets_; ///< DAG in CSR format.
+    std::vector<bool> cyclic_;
+    size_t num_nontrivial_  = 0;
+    size_t num_unreachable_ = 0;
+    size_t num_non_exiting_ = 0;
+    bool reducible_         = true;
+};
+
+} // namespace graphtool
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <ostream>
 #include <vector>
 
@@ -19,11 +20,13 @@ public:
 
     class Node {
     private:
-        Node(Sym name)
-            : name_(name) {}
+        Node(Sym name, size_t id)
+            : name_(name)
+            , id_(id) {}
 
     public:
         Sym name() const { return name_; }
+        size_t id() const { return id_; } ///< Dense index in order of creation.
 
         void link(Node* succ) {
             this->succs_.emplace(succ);
@@ -32,6 +35,7 @@ public:
 
     private:
         Sym name_;
+        size_t id_;
         NodeSet preds_, succs_;
 
         struct Order {
@@ -43,9 +47,10 @@ public:
         std::array<Order, 2> order_;
         std::array<Node*, 2> idom_;
         std::array<std::vector<Node*>, 2> children_;
-        std::array<NodeSet, 2> frontier_;
+        std::array<std::vector<Node*>, 2> frontier_; ///< In reverse post order.
 
         friend class Graph;
+        friend class Condensation;
         template<size_t M>
         friend class BiGraph;
     };
@@ -58,7 +63,9 @@ public:
         , name_(other.name_)
         , entry_(other.entry_)
         , exit_(other.exit_)
-        , nodes_(std::move(other.nodes_)) {}
+        , nodes_(std::move(other.nodes_))
+        , id2node_(std::move(other.id2node_))
+        , edges_(std::move(other.edges_)) {}
     ~Graph();
 
     Graph& operator=(const Graph&) = delete;
@@ -69,20 +76,33 @@ public:
     fe::Driver& driver() { return driver_; }
     Sym name() const { return name_; }
     const auto& nodes() const { return nodes_; }
+    Node* node(size_t id) const { return id2node_[id]; }
+    size_t num_nodes() const { return id2node_.size(); }
     ///@}
 
     void set_name(Sym name) { name_ = name; }
     Node* node(Sym name); ///< Construct Graph::Node without duplicates.
     void critical_edge_elimination();
 
+    /// @name Bulk Builder
+    /// Graph::edge merely records an edge; Graph::finalize links all recorded edges at once.
+    /// This is cheaper than Node::link for many - possibly duplicate - edges.
+    /// Recorded edges have no effect until Graph::finalize; the analyses assert that none are pending.
+    ///@{
+    void edge(Node* src, Node* dst) { edges_.emplace_back(uint64_t(src->id()) << 32 | uint64_t(dst->id())); }
+    void finalize();
+    ///@}
+
     friend void swap(Graph& g1, Graph& g2) noexcept {
         using std::swap;
         // clang-format off
-        swap(g1.driver_, g2.driver_);
-        swap(g1.name_,   g2.name_);
-        swap(g1.entry_,  g2.entry_);
-        swap(g1.exit_,   g2.exit_);
-        swap(g1.nodes_,  g2.nodes_);
+        swap(g1.driver_,  g2.driver_);
+        swap(g1.name_,    g2.name_);
+        swap(g1.entry_,   g2.entry_);
+        swap(g1.exit_,    g2.exit_);
+        swap(g1.nodes_,   g2.nodes_);
+        swap(g1.id2node_, g2.id2node_);
+        swap(g1.edges_,   g2.edges_);
         // clang-format on
     }
 
@@ -92,22 +112,33 @@ private:
     Node* entry_ = nullptr;
     Node* exit_  = nullptr;
     fe::SymMap<Node*> nodes_;
+    std::vector<Node*> id2node_;
+    std::vector<uint64_t> edges_; ///< Recorded but not yet linked edges: `src << 32 | dst`.
     std::array<std::vector<Node*>, 2> rpo_;
 
+    friend class Condensation;
     template<size_t M>
     friend class BiGraph;
 };
 
+/// How BiGraph computes dominance; all engines yield identical results.
+enum class Engine {
+    Auto,    ///< Currently Engine::Generic: Engine::Bits doesn't clearly win on any size.
+    Generic, ///< Cooper et al. directly on the Graph.
+    Bits,    ///< Word-parallel data-flow on bitsets for up to BiGraph::Max_Bits nodes, Engine::Generic otherwise.
+};
+
 template<size_t M>
 class BiGraph {
 public:
     using Node = Graph::Node;
 
-    BiGraph(Graph& graph)
+    static constexpr size_t Max_Bits = 256; ///< Largest BitSet capacity used by Engine::Bits.
+
+    BiGraph(Graph& graph, Engine engine = Engine::Auto)
         : graph_(graph) {
-        number();
-        dom();
-        dom_frontiers();
+        assert(graph.edges_.empty());
+        analyze(engine);
     }
 
     /// @name Node Wrappers
@@ -141,12 +172,21 @@ public:
     void dump_dom_frontiers(std::ostream&) const;
     ///@}
 
+    /// Certifies the dominator tree in linear time; irreducible regions fall back to O(m log n) local dominators.
+    /// @throws std::logic_error naming the first violating Node in reverse post order.
+    void verify() const;
+
 private:
+    void analyze(Engine);
     void number();
     void dom();
     void dom_frontiers();
     Node* lca(Node*, Node*);
 
+    /// Computes dominators and dominance frontiers at once on BitSet%s of capacity @p N.
+    template<size_t N>
+    void dom_bits();
+
     Graph& graph_;
 };
 
@@ -18,9 +18,11 @@ public:
     Graph parse_graph();
 
 private:
-    Graph::NodeSet parse_sub_graph(std::string_view ctxt);
-    void parse_stmt_list(Graph::NodeSet&);
-    void parse_edge_stmt(Graph::NodeSet&);
+    using Nodes = std::vector<Graph::Node*>;
+
+    Nodes parse_sub_graph(std::string_view ctxt);
+    void parse_stmt_list(Nodes&);
+    void parse_edge_stmt(Nodes&);
 
     /// Issue an error message of the form:
     /// `expected <what>, got '<tok>' while parsing <ctxt>`
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "graphtool/condensation.h"
+
+namespace graphtool {
+
+/// Index that answers whether one Graph::Node can reach another one.
+/// Queries are answered on the Condensation DAG of the strongly connected components (SCCs):
+/// * Up to a given number of SCCs, the transitive closure is stored as bitsets and all queries take constant time.
+/// * Beyond that, GRAIL interval labels refute most unreachable pairs in constant time,
+///   a DFS spanning forest confirms tree descendants, and a label-pruned DFS decides the rest.
+///
+/// Queries don't modify the index; hence, several threads may query the same Reach concurrently.
+class Reach {
+public:
+    using Node  = Graph::Node;
+    using Query = std::pair<Node*, Node*>;
+
+    static constexpr size_t Closure_Threshold = 4096; ///< Use a transitive closure up to this many SCCs.
+    static constexpr size_t Num_Labels        = 3;    ///< Number of GRAIL labels per SCC otherwise.
+
+    Reach(const Graph& graph, size_t threshold = Closure_Threshold, size_t num_labels = Num_Labels, uint64_t seed = 0)
+        : Reach(Condensation(graph), threshold, num_labels, seed) {}
+    Reach(Condensation, size_t threshold = Closure_Threshold, size_t num_labels = Num_Labels, uint64_t seed = 0);
+
+    /// @name Getters
+    ///@{
+    const Condensation& condensation() const { return cond_; }
+    size_t num_sccs() const { return cond_.num_sccs(); }
+    size_t scc(const Node* n) const { return cond_.scc(n); } ///< SCCs are in reverse topological order.
+    bool has_closure() const { return !closure_.empty(); }
+    ///@}
+
+    /// @name Queries
+    ///@{
+    bool reaches(const Node* a, const Node* b) const; ///< Can @p a reach @p b?
+    std::vector<bool> reaches(std::span<const Query>) const; ///< Shares scratch space among all @p queries.
+    ///@}
+
+private:
+    /// Per-call scratch space of Reach::search.
+    struct Scratch {
+        std::vector<size_t> visited, stack;
+        size_t stamp = 0;
+    };
+
+    void close();
+    void label(size_t num_labels, uint64_t seed);
+    bool contains(size_t u, size_t v) const; ///< Do all labels of @p u contain the ones of @p v?
+    bool reaches(size_t u, size_t v, Scratch&) const;
+    bool search(size_t u, size_t v, Scratch&) const;
+
+    struct Interval {
+        size_t lo, hi;
+    };
+
+    Condensation cond_;
+    size_t words_ = 0;
+    std::vector<uint64_t> closure_; ///< Reachable SCCs as bitset of Reach::words_ words per SCC.
+    size_t num_labels_ = 0;
+    std::vector<Interval> labels_; ///< Reach::num_labels_ labels per SCC.
+    std::vector<Interval> tree_;   ///< Pre/post numbers of the first labeling's DFS spanning forest.
+};
+
+} // namespace graphtool
@@ -0,0 +1,249 @@
+#include "graphtool/condensation.h"
+
+#include <algorithm>
+#include <numeric>
+#include <ranges>
+
+namespace graphtool {
+
+/*
+ * SCCs
+ */
+
+// Pearce, 2016. A Space-Efficient Algorithm for Finding Strongly Connected Components.
+// https://doi.org/10.1016/j.ipl.2015.08.010
+// Iterative version; afterwards, the Node%s in the same SCC share an rindex.
+// SCCs are numbered downwards from `n - 1` as they are finished - i.e. in topological order.
+std::vector<size_t> Condensation::pearce(const CSR& succs) {
+    auto n = succs.offsets.size() - 1;
+    std::vector<size_t> rindex(n), stack;
+    std::vector<bool> root(n);
+    std::vector<std::pair<size_t, size_t>> call; // node, next edge
+    size_t index = 1, c = n - 1;
+
+    auto visit = [&](size_t v) {
+        rindex[v] = index++;
+        root[v]   = true;
+        call.emplace_back(v, succs.offsets[v]);
+    };
+
+    for (size_t r = 0; r != n; ++r) {
+        if (rindex[r] != 0) continue;
+        visit(r);
+
+        while (!call.empty()) {
+            auto& [v, i] = call.back();
+            if (i != succs.offsets[v + 1]) {
+                auto w = succs.targets[i++];
+                if (rindex[w] == 0) {
+                    visit(w);
+                } else if (rindex[w] < rindex[v]) {
+                    rindex[v] = rindex[w];
+                    root[v]   = false;
+                }
+                continue;
+            }
+
+            auto u = v;
+            call.pop_back();
+            if (root[u]) {
+                --index;
+                while (!stack.empty() && rindex[u] <= rindex[stack.back()]) {
+                    rindex[stack.back()] = c;
+                    stack.pop_back();
+                    --index;
+                }
+                rindex[u] = c--;
+            } else {
+                stack.emplace_back(u);
+            }
+
+            if (!call.empty()) {
+                auto p = call.back().first;
+                if (rindex[u] < rindex[p]) {
+                    rindex[p] = rindex[u];
+                    root[p]   = false;
+                }
+            }
+        }
+    }
+
+    return rindex;
+}
+
+Condensation::Condensation(const Graph& graph)
+    : name_(graph.name()) {
+    // flatten adjacency into CSR format once - the hash sets are slow to traverse
+    auto n = graph.num_nodes();
+    CSR succs, preds;
+    succs.offsets.resize(n + 1);
+    preds.offsets.resize(n + 1);
+    for (size_t v = 0; v != n; ++v) {
+        for (auto succ : graph.node(v)->succs_) succs.targets.emplace_back(succ->id());
+        for (auto pred : graph.node(v)->preds_) preds.targets.emplace_back(pred->id());
+        succs.offsets[v + 1] = succs.targets.size();
+        preds.offsets[v + 1] = preds.targets.size();
+    }
+
+    scc_ = pearce(succs);
+
+    // renumber in reverse topological order
+    size_t num_sccs = 0;
+    for (auto& c : scc_) {
+        c        = n - 1 - c;
+        num_sccs = std::max(num_sccs, c + 1);
+    }
+
+    // group nodes by SCC
+    first_.assign(num_sccs + 1, 0);
+    members_.resize(n);
+    for (size_t v = 0; v != n; ++v) ++first_[scc_[v] + 1];
+    for (size_t c = 0; c != num_sccs; ++c) first_[c + 1] += first_[c];
+    for (size_t v = 0; v != n; ++v) members_[first_[scc_[v]]++] = graph.node(v);
+    for (size_t c = num_sccs; c-- > 0;) first_[c + 1] = first_[c];
+    first_[0] = 0;
+
+    // collect the edges between distinct SCCs without duplicates
+    std::vector<size_t> mark(num_sccs, Not_Visited);
+    offsets_.assign(num_sccs + 1, 0);
+    cyclic_.resize(num_sccs);
+    for (size_t c = 0; c != num_sccs; ++c) {
+        cyclic_[c] = members(c).size() > 1;
+        for (auto m : members(c)) {
+            for (size_t i = succs.offsets[m->id()]; i != succs.offsets[m->id() + 1]; ++i) {
+                auto d = scc_[succs.targets[i]];
+                if (d == c) {
+                    cyclic_[c] = true;
+                } else if (mark[d] != c) {
+                    mark[d] = c;
+                    targets_.emplace_back(d);
+                }
+            }
+        }
+        offsets_[c + 1] = targets_.size();
+        if (cyclic_[c]) ++num_nontrivial_;
+    }
+
+    if (n == 0) return;
+
+    // edges only go from later to earlier SCCs - so a single sweep over the DAG in each direction suffices
+    std::vector<bool> reachable(num_sccs), exiting(num_sccs);
+    reachable[scc(graph.entry_)] = true;
+    for (size_t c = num_sccs; c-- > 0;) {
+        if (!reachable[c]) {
+            num_unreachable_ += members(c).size();
+            continue;
+        }
+        for (auto d : this->succs(c)) reachable[d] = true;
+    }
+    auto exits = [&](size_t d) { return exiting[d]; };
+    for (size_t c = 0; c != num_sccs; ++c) {
+        exiting[c] = c == scc(graph.exit_) || std::ranges::any_of(this->succs(c), exits);
+        if (!exiting[c]) num_non_exiting_ += members(c).size();
+    }
+
+    reducible_ = classify(graph.entry_->id(), succs, preds);
+}
+
+/*
+ * reducibility
+ */
+
+// Tarjan, 1974. Testing Flow Graph Reducibility. https://doi.org/10.1016/S0022-0000(74)80043-7
+// An edge (v, w) is a back edge iff w is an ancestor of v in a DFS tree from entry.
+// The graph is reducible iff each back edge target w is the single entry of the loop formed by these back edges:
+// In reverse preorder, we collect the loop body of each w backwards from its back edge sources
+// and then merge it into w with union-find - inner loops are thus represented by their headers.
+// A predecessor of the body that doesn't descend from w enters the loop past w.
+// Unreachable Node%s are ignored.
+bool Condensation::classify(size_t entry, const CSR& succs, const CSR& preds) const {
+    auto n = num_nodes();
+    std::vector<size_t> pre(n, Not_Visited), last(n), vertex{entry}; // last: largest pre number in the DFS subtree
+    std::vector<std::pair<size_t, size_t>> call{{entry, succs.offsets[entry]}};
+    pre[entry] = 0;
+    while (!call.empty()) {
+        auto& [v, i] = call.back();
+        if (i != succs.offsets[v + 1]) {
+            if (auto w = succs.targets[i++]; pre[w] == Not_Visited) {
+                pre[w] = vertex.size();
+                vertex.emplace_back(w);
+                call.emplace_back(w, succs.offsets[w]);
+            }
+        } else {
+            last[v] = vertex.size() - 1;
+            call.pop_back();
+        }
+    }
+    auto descends = [&](size_t v, size_t w) { return pre[w] <= pre[v] && pre[v] <= last[w]; };
+
+    std::vector<size_t> header(n), body;
+    std::iota(header.begin(), header.end(), 0);
+    auto find = [&](size_t v) {
+        while (header[v] != v) v = header[v] = header[header[v]];
+        return v;
+    };
+
+    std::vector<bool> in_body(n);
+    auto add = [&](size_t x, size_t w) {
+        if (x != w && !in_body[x]) {
+            in_body[x] = true;
+            body.emplace_back(x);
+        }
+    };
+
+    for (auto w : vertex | std::views::reverse) {
+        for (size_t i = preds.offsets[w]; i != preds.offsets[w + 1]; ++i) {
+            if (auto v = preds.targets[i]; pre[v] != Not_Visited && descends(v, w)) add(find(v), w);
+        }
+        for (size_t j = 0; j != body.size(); ++j) {
+            auto x = body[j];
+            for (size_t i = preds.offsets[x]; i != preds.offsets[x + 1]; ++i) {
+                auto v = preds.targets[i];
+                if (pre[v] == Not_Visited) continue;
+                auto y = find(v);
+                if (!descends(y, w)) return false;
+                add(y, w);
+            }
+        }
+        for (auto x : body) {
+            header[x]  = w;
+            in_body[x] = false;
+        }
+        body.clear();
+    }
+
+    return true;
+}
+
+/*
+ * output
+ */
+
+void Condensation::dump(std::ostream& os) const {
+    auto dot = [&](size_t c) {
+        std::string label;
+        for (const char* sep = ""; auto m : members(c)) {
+            label += std::format("{}{}", sep, m->name());
+            sep = " ";
+        }
+        return std::format("\"{}\"", label);
+    };
+
+    auto kind = reducible() ? "reducible" : "irreducible";
+    os << std::format("// {} SCCs, {} nontrivial, {}", num_sccs(), num_nontrivial(), kind) << std::endl;
+    os << std::format("digraph {} {{", name()) << std::endl;
+    const char* sep = "";
+    for (size_t c = num_sccs(); c-- > 0;) {
+        if (succs(c).empty()) {
+            os << sep << std::format("\t{}", dot(c));
+            sep = "\n";
+        }
+        for (auto d : succs(c)) {
+            os << sep << std::format("\t{} -> {}", dot(c), dot(d));
+            sep = "\n";
+        }
+    }
+    os << std::endl << '}' << std::endl;
+}
+
+} // namespace graphtool
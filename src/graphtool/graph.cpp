@@ -1,6 +1,11 @@
 #include "graphtool/graph.h"
 
+#include <algorithm>
+#include <numeric>
 #include <ranges>
+#include <stdexcept>
+
+#include "graphtool/bitset.h"
 
 namespace graphtool {
 
@@ -10,14 +15,35 @@ Graph::~Graph() {
 
 Graph::Node* Graph::node(Sym name) {
     if (auto i = nodes_.find(name); i != nodes_.end()) return exit_ = i->second;
-    auto node = new Node(name);
+    auto node = new Node(name, id2node_.size());
     if (entry_ == nullptr) entry_ = node;
     auto [_, ins] = nodes_.emplace(name, node);
     assert_unused(ins);
+    id2node_.emplace_back(node);
     return exit_ = node;
 }
 
+// Sorting makes duplicates adjacent; the hash sets only see each edge once.
+void Graph::finalize() {
+    assert(id2node_.size() <= (uint64_t(1) << 32));
+    std::ranges::sort(edges_);
+    edges_.erase(std::unique(edges_.begin(), edges_.end()), edges_.end());
+
+    // reserve exactly once and link
+    std::vector<size_t> num_preds(id2node_.size()), num_succs(id2node_.size());
+    for (auto e : edges_) ++num_succs[e >> 32], ++num_preds[e & 0xffffffff];
+    for (auto node : id2node_) {
+        node->preds_.reserve(node->preds_.size() + num_preds[node->id()]);
+        node->succs_.reserve(node->succs_.size() + num_succs[node->id()]);
+    }
+    for (auto e : edges_) node(e >> 32)->link(node(e & 0xffffffff));
+
+    edges_.clear();
+    edges_.shrink_to_fit();
+}
+
 void Graph::critical_edge_elimination() {
+    assert(edges_.empty());
     std::vector<std::pair<Node*, Node*>> crit;
     auto x = exit_; // we create new nodes below - so memorize proper exit ...
 
@@ -41,6 +67,32 @@ void Graph::critical_edge_elimination() {
     exit_ = x; // ... and restore again
 }
 
+/*
+ * analyze
+ */
+
+template<size_t M>
+void BiGraph<M>::analyze(Engine engine) {
+    // reset results from a previous run
+    for (auto [_, node] : graph_.nodes()) {
+        order(node) = {};
+        children(node).clear();
+        frontier(node).clear();
+    }
+    rpo().clear();
+
+    number();
+    // Both engines first walk the hash sets in number(); bitsets don't save enough afterwards (see graphtool --bench).
+    auto n = rpo().size();
+    if (engine == Engine::Bits) {
+        if (n <= 64) return dom_bits<64>();
+        if (n <= 128) return dom_bits<128>();
+        if (n <= Max_Bits) return dom_bits<Max_Bits>();
+    }
+    dom();
+    dom_frontiers();
+}
+
 /*
  * number
  */
@@ -95,7 +147,9 @@ void BiGraph<M>::dom() {
 
         for (auto n : rpo() | std::views::drop(1)) {
             Node* new_idom = nullptr;
-            for (auto pred : preds(n)) new_idom = new_idom ? lca(new_idom, pred) : pred;
+            for (auto pred : preds(n)) {
+                if (rp(pred) != Not_Visited) new_idom = new_idom ? lca(new_idom, pred) : pred;
+            }
 
             assert(new_idom);
             if (idom(n) != new_idom) {
@@ -125,10 +179,294 @@ void BiGraph<M>::dom_frontiers() {
         if (preds.size() > 1) {
             auto idom = this->idom(n);
             for (auto pred : preds) {
-                for (auto i = pred; i != idom; i = this->idom(i)) frontier(i).emplace(n);
+                if (rp(pred) == Not_Visited) continue;
+                for (auto i = pred; i != idom; i = this->idom(i)) {
+                    if (frontier(i).empty() || frontier(i).back() != n) frontier(i).emplace_back(n);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * bitsets
+ */
+
+// Dom(n) = {n} ∪ ⋂ Dom(p) for all preds p - each BitSet is indexed by reverse post order.
+// The first pass in reverse post order ignores retreating edges and is already exact if each of them is a back edge.
+// Otherwise, the graph is irreducible and we iterate until a fixed point is reached.
+// The strict dominators of n form a chain; the one with the largest rp is idom(n).
+// The walk from a pred p of n up to idom(n) in BiGraph::dom_frontiers visits exactly Dom(p) \ Dom(idom(n)).
+template<size_t M>
+template<size_t N>
+void BiGraph<M>::dom_bits() {
+    auto size = rpo().size();
+    assert(size <= N);
+    std::array<BitSet<N>, N> preds, doms;
+    std::vector<std::pair<size_t, size_t>> retreating;
+    auto all = BitSet<N>::first(size);
+
+    doms[0].set(0);
+    for (size_t i = 1; i != size; ++i) {
+        auto new_doms = all;
+        for (auto pred : this->preds(rpo()[i])) {
+            auto p = rp(pred);
+            if (p == Not_Visited) continue;
+            preds[i].set(p);
+            if (p < i) {
+                new_doms &= doms[p];
+            } else {
+                retreating.emplace_back(p, i);
+            }
+        }
+        doms[i] = new_doms.set(i);
+    }
+
+    bool reducible = std::ranges::all_of(retreating, [&](auto edge) { return doms[edge.first].test(edge.second); });
+    for (bool todo = !reducible; todo;) {
+        todo = false;
+
+        for (size_t i = 1; i != size; ++i) {
+            auto new_doms = doms[i];
+            preds[i].for_each([&](size_t p) { new_doms &= doms[p]; });
+            new_doms.set(i);
+            if (doms[i] != new_doms) {
+                doms[i] = new_doms;
+                todo    = true;
+            }
+        }
+    }
+
+    idom(entry()) = entry();
+    for (size_t i = 1; i != size; ++i) {
+        auto n  = rpo()[i];
+        auto d  = BitSet<N>(doms[i]).reset(i).last();
+        idom(n) = rpo()[d];
+        children(idom(n)).emplace_back(n);
+        if (this->preds(n).size() > 1) {
+            BitSet<N> walks;
+            preds[i].for_each([&](size_t p) { walks |= doms[p]; });
+            (walks & ~doms[d]).for_each([&](size_t j) { frontier(rpo()[j]).emplace_back(n); });
+        }
+    }
+}
+
+/*
+ * verify
+ */
+
+// Georgiadis & Tarjan, 2016. Dominator Tree Certification and Divergent Spanning Trees. https://doi.org/10.1145/2764913
+// A tree D rooted at entry is the dominator tree iff
+// 1. parent property: for each edge (v, w), idom(w) is an ancestor of v in D, and
+// 2. sibling property: no Node dominates one of its siblings in D.
+// For 2., each edge (v, w) becomes a derived edge (v', w) where v' is the child of idom(w) on the path to v in D.
+// Then, 2. holds iff the siblings admit a low-high order - we grow one greedily:
+// w is placed right after idom(w) if (idom(w), w) is an edge, or between two distinct placed derived preds otherwise.
+// This only stalls on derived cycles due to irreducible control flow.
+// For the stalled siblings, we directly compute dominators on the derived graph of their parent instead.
+// As each derived edge belongs to exactly one such graph, this fallback takes O(m log n) time in total.
+template<size_t M>
+void BiGraph<M>::verify() const {
+    const auto& rpo = this->rpo();
+    auto n          = graph_.num_nodes();
+    Node* bad       = nullptr;
+    std::string why;
+
+    auto violate = [&](Node* w, std::string what) {
+        if (!bad || rp(w) < rp(bad)) {
+            bad = w;
+            why = std::move(what);
+        }
+    };
+    auto check = [&]() {
+        if (bad) {
+            auto tree = M == 0 ? "dominator" : "postdominator";
+            throw std::logic_error(std::format("{} tree is wrong at node '{}': {}", tree, bad->name(), why));
+        }
+    };
+
+    // structure: idoms precede their Nodes in reverse post order and agree with the children
+    std::vector<size_t> depth(n);
+    if (idom(entry()) != entry()) violate(entry(), "entry is not its own idom");
+    for (auto w : rpo | std::views::drop(1)) {
+        auto d = idom(w);
+        if (d == nullptr || rp(d) == Not_Visited || rp(d) >= rp(w)) {
+            violate(w, "idom doesn't precede the node in reverse post order");
+        } else {
+            depth[w->id()] = depth[d->id()] + 1;
+        }
+    }
+
+    std::vector<bool> placed(n);
+    for (auto u : rpo) {
+        for (auto c : children(u)) {
+            if (c == entry() || idom(c) != u || placed[c->id()]) violate(c, "children and idom disagree");
+            placed[c->id()] = true;
+        }
+    }
+    for (auto w : rpo | std::views::drop(1)) {
+        if (!placed[w->id()]) violate(w, "node is missing from the children of its idom");
+    }
+    check();
+
+    // parent property: DFS over D while keeping track of the path from entry
+    std::vector<Node*> path(rpo.size());
+    std::vector<bool> parent_edge(n);
+    std::vector<std::pair<size_t, size_t>> derived;
+    std::vector<std::pair<Node*, size_t>> stack;
+
+    auto visit = [&](Node* v) {
+        path[depth[v->id()]] = v;
+        for (auto w : succs(v)) {
+            if (w == entry()) continue;
+            auto d = idom(w);
+            auto i = depth[d->id()];
+            if (i > depth[v->id()] || path[i] != d) {
+                violate(w, std::format("idom '{}' is no ancestor of pred '{}'", d->name(), v->name()));
+            } else if (d == v) {
+                parent_edge[w->id()] = true;
+            } else if (auto s = path[i + 1]; s != w) {
+                derived.emplace_back(s->id(), w->id());
+            }
+        }
+        stack.emplace_back(v, 0);
+    };
+
+    visit(entry());
+    while (!stack.empty()) {
+        auto& [u, i] = stack.back();
+        if (i != children(u).size()) {
+            visit(children(u)[i++]);
+        } else {
+            stack.pop_back();
+        }
+    }
+    check();
+
+    // sibling property: derived edges in CSR format by source
+    std::vector<size_t> offsets(n + 1), targets(derived.size());
+    for (auto [s, _] : derived) ++offsets[s + 1];
+    for (size_t i = 0; i != n; ++i) offsets[i + 1] += offsets[i];
+    auto pos = offsets;
+    for (auto [s, w] : derived) targets[pos[s]++] = w;
+
+    std::vector<size_t> first(n, Not_Visited), queue{entry()->id()}; // first placed derived pred
+    placed.assign(n, false);
+    placed[entry()->id()] = true;
+    for (auto w : rpo | std::views::drop(1)) {
+        if (parent_edge[w->id()]) {
+            placed[w->id()] = true;
+            queue.emplace_back(w->id());
+        }
+    }
+
+    for (size_t j = 0; j != queue.size(); ++j) {
+        auto x = queue[j];
+        for (size_t i = offsets[x]; i != offsets[x + 1]; ++i) {
+            auto w = targets[i];
+            if (placed[w]) continue;
+            if (first[w] == Not_Visited) {
+                first[w] = x;
+            } else if (first[w] != x) {
+                placed[w] = true;
+                queue.emplace_back(w);
+            }
+        }
+    }
+    if (queue.size() == rpo.size()) return;
+
+    // Lengauer & Tarjan, 1979. A Fast Algorithm for Finding Dominators in a Flowgraph.
+    // https://doi.org/10.1145/357062.357071
+    // Simple version on the derived graph of u's children; u itself has local index 0.
+    std::vector<size_t> local(n);
+    auto siblings = [&](Node* u) {
+        const auto& cs = children(u);
+        auto k         = cs.size() + 1;
+        std::vector<std::vector<size_t>> in(k), out(k);
+        for (size_t j = 1; j != k; ++j) local[cs[j - 1]->id()] = j;
+        for (size_t j = 1; j != k; ++j) {
+            auto c = cs[j - 1]->id();
+            if (parent_edge[c]) {
+                out[0].emplace_back(j);
+                in[j].emplace_back(0);
+            }
+            for (size_t i = offsets[c]; i != offsets[c + 1]; ++i) {
+                auto t = local[targets[i]];
+                out[j].emplace_back(t);
+                in[t].emplace_back(j);
+            }
+        }
+
+        // DFS numbering; 0 is u
+        std::vector<size_t> pre(k, Not_Visited), vertex{0}, parent{0};
+        std::vector<std::pair<size_t, size_t>> dfs{{0, 0}};
+        pre[0] = 0;
+        while (!dfs.empty()) {
+            auto& [v, i] = dfs.back();
+            if (i != out[v].size()) {
+                if (auto t = out[v][i++]; pre[t] == Not_Visited) {
+                    parent.emplace_back(pre[v]);
+                    pre[t] = vertex.size();
+                    vertex.emplace_back(t);
+                    dfs.emplace_back(t, 0);
+                }
+            } else {
+                dfs.pop_back();
             }
         }
+
+        // semidominators with path compression; buckets are linked lists through next
+        auto num = vertex.size();
+        std::vector<size_t> semi(num), label(num), doms(num), next(num), path;
+        std::vector<size_t> ancestor(num, Not_Visited), head(num, Not_Visited);
+        std::iota(semi.begin(), semi.end(), 0);
+        std::iota(label.begin(), label.end(), 0);
+        auto eval = [&](size_t v) {
+            if (ancestor[v] == Not_Visited) return v;
+            for (auto x = v; ancestor[ancestor[x]] != Not_Visited; x = ancestor[x]) path.emplace_back(x);
+            for (; !path.empty(); path.pop_back()) {
+                auto x = path.back(), a = ancestor[x];
+                if (semi[label[a]] < semi[label[x]]) label[x] = label[a];
+                ancestor[x] = ancestor[a];
+            }
+            return label[v];
+        };
+        for (size_t w = num; w-- > 1;) {
+            for (auto v : in[vertex[w]]) {
+                if (pre[v] != Not_Visited) semi[w] = std::min(semi[w], semi[eval(pre[v])]);
+            }
+            auto p        = parent[w];
+            next[w]       = head[semi[w]];
+            head[semi[w]] = w;
+            ancestor[w]   = p;
+            for (auto v = head[p]; v != Not_Visited; v = next[v]) {
+                auto x  = eval(v);
+                doms[v] = semi[x] < semi[v] ? x : p;
+            }
+            head[p] = Not_Visited;
+        }
+        for (size_t w = 1; w != num; ++w) {
+            if (doms[w] != semi[w]) doms[w] = doms[doms[w]];
+        }
+
+        for (size_t j = 1; j != k; ++j) {
+            if (pre[j] == Not_Visited) {
+                violate(cs[j - 1], "node is unreachable from its idom");
+            } else if (auto d = doms[pre[j]]; d != 0) {
+                violate(cs[j - 1], std::format("node is dominated by its sibling '{}'", cs[vertex[d] - 1]->name()));
+            }
+        }
+    };
+
+    std::vector<bool> checked(n);
+    for (auto w : rpo | std::views::drop(1)) {
+        auto u = idom(w);
+        if (!placed[w->id()] && !checked[u->id()]) {
+            checked[u->id()] = true;
+            siblings(u);
+        }
     }
+    check();
 }
 
 /*
@@ -1,5 +1,6 @@
 #include "graphtool/parser.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -30,17 +31,22 @@ Graph Parser::parse_graph() {
     if (auto tok = accept(Tok::Tag::V_sym)) graph_.set_name(tok.sym());
     parse_sub_graph("graph");
     expect(Tag::EoF, "graph");
+    graph_.finalize();
 
     return std::move(graph_);
 }
 
-Graph::NodeSet Parser::parse_sub_graph(std::string_view ctxt) {
-    Graph::NodeSet nodes;
+Parser::Nodes Parser::parse_sub_graph(std::string_view ctxt) {
+    Nodes nodes;
     if (auto tok = accept(Tok::Tag::V_sym)) {
-        nodes.emplace(graph_.node(tok.sym()));
+        nodes.emplace_back(graph_.node(tok.sym()));
     } else if (accept(Tag::D_brace_l)) {
         parse_stmt_list(nodes);
         expect(Tag::D_brace_r, "subgraph");
+        // remove duplicates - otherwise they multiply in nested edge statements
+        std::ranges::sort(nodes, {}, &Graph::Node::id);
+        auto [i, e] = std::ranges::unique(nodes);
+        nodes.erase(i, e);
     } else {
         err("subgraph", ctxt);
     }
@@ -48,7 +54,7 @@ Graph::NodeSet Parser::parse_sub_graph(std::string_view ctxt) {
     return nodes;
 }
 
-void Parser::parse_stmt_list(Graph::NodeSet& nodes) {
+void Parser::parse_stmt_list(Nodes& nodes) {
     while (true) {
         // clang-format off
         switch (ahead().tag()) {
@@ -62,15 +68,15 @@ void Parser::parse_stmt_list(Graph::NodeSet& nodes) {
     }
 }
 
-void Parser::parse_edge_stmt(Graph::NodeSet& nodes) {
+void Parser::parse_edge_stmt(Nodes& nodes) {
     auto lhs = parse_sub_graph("edge statement");
-    nodes.insert(lhs.begin(), lhs.end());
+    nodes.insert(nodes.end(), lhs.begin(), lhs.end());
     while (accept(Tag::T_arrow)) {
         auto rhs = parse_sub_graph("edge statement");
-        nodes.insert(rhs.begin(), rhs.end());
+        nodes.insert(nodes.end(), rhs.begin(), rhs.end());
 
         for (auto pred : lhs) {
-            for (auto succ : rhs) pred->link(succ);
+            for (auto succ : rhs) graph_.edge(pred, succ);
         }
 
         lhs = std::move(rhs);
@@ -0,0 +1,158 @@
+#include "graphtool/reach.h"
+
+#include <algorithm>
+#include <random>
+
+namespace graphtool {
+
+Reach::Reach(Condensation cond, size_t threshold, size_t num_labels, uint64_t seed)
+    : cond_(std::move(cond)) {
+    if (num_sccs() <= threshold) {
+        close();
+    } else {
+        label(num_labels, seed);
+    }
+}
+
+/*
+ * transitive closure
+ */
+
+void Reach::close() {
+    auto n = num_sccs();
+    words_ = (n + 63) / 64;
+    closure_.assign(n * words_, 0);
+    for (size_t c = 0; c != n; ++c) {
+        auto row = closure_.data() + c * words_;
+        row[c / 64] |= uint64_t(1) << c % 64;
+        for (auto d : cond_.succs(c)) {
+            auto succ = closure_.data() + d * words_;
+            for (size_t w = 0; w != words_; ++w) row[w] |= succ[w];
+        }
+    }
+}
+
+/*
+ * GRAIL labels
+ */
+
+// Yildirim et al, 2010. GRAIL: Scalable Reachability Index for Large Graphs. https://doi.org/10.14778/1920841.1920879
+// Each label [lo, hi] of an SCC contains the labels of all its successors; hence, non-containment refutes reachability.
+void Reach::label(size_t num_labels, uint64_t seed) {
+    auto n      = num_sccs();
+    num_labels_ = num_labels;
+    labels_.assign(n * num_labels_, {Not_Visited, Not_Visited});
+    tree_.assign(n, {Not_Visited, Not_Visited});
+
+    std::vector<size_t> roots;
+    std::vector<bool> has_pred(n);
+    for (size_t c = 0; c != n; ++c) {
+        for (auto d : cond_.succs(c)) has_pred[d] = true;
+    }
+    for (size_t c = 0; c != n; ++c) {
+        if (!has_pred[c]) roots.emplace_back(c);
+    }
+
+    std::mt19937_64 rng(seed);
+    std::vector<std::pair<size_t, size_t>> stack; // SCC, number of visited successors
+    std::vector<size_t> start(n);
+    for (size_t l = 0; l != num_labels_; ++l) {
+        auto label = [&](size_t c) -> Interval& { return labels_[c * num_labels_ + l]; };
+        std::ranges::shuffle(roots, rng);
+        for (size_t c = 0; c != n; ++c) {
+            auto deg = cond_.succs(c).size();
+            start[c] = deg ? rng() % deg : 0;
+        }
+
+        size_t pre = 0, post = 0;
+        for (auto root : roots) {
+            if (label(root).lo != Not_Visited) continue;
+            label(root).lo = post + n; // larger than any post number
+            if (l == 0) tree_[root].lo = pre++;
+            stack.emplace_back(root, 0);
+
+            while (!stack.empty()) {
+                auto& [c, k] = stack.back();
+                auto succs   = cond_.succs(c);
+                if (k != succs.size()) {
+                    auto d = succs[(start[c] + k++) % succs.size()];
+                    if (label(d).lo == Not_Visited) {
+                        label(d).lo = post + n;
+                        if (l == 0) tree_[d].lo = pre++;
+                        stack.emplace_back(d, 0);
+                    } else {
+                        label(c).lo = std::min(label(c).lo, label(d).lo);
+                    }
+                    continue;
+                }
+
+                auto& lab = label(c);
+                lab.hi    = post++;
+                lab.lo    = std::min(lab.lo, lab.hi);
+                if (l == 0) tree_[c].hi = lab.hi;
+                auto lo = lab.lo;
+                stack.pop_back();
+                if (!stack.empty()) {
+                    auto& parent = label(stack.back().first);
+                    parent.lo    = std::min(parent.lo, lo);
+                }
+            }
+        }
+    }
+}
+
+bool Reach::contains(size_t u, size_t v) const {
+    for (size_t l = 0; l != num_labels_; ++l) {
+        auto lu = labels_[u * num_labels_ + l], lv = labels_[v * num_labels_ + l];
+        if (lv.lo < lu.lo || lu.hi < lv.hi) return false;
+    }
+    return true;
+}
+
+// DFS that prunes all SCCs that can't reach v according to their labels or the topological order.
+// @p scratch is only allocated on first use - most queries never get here.
+bool Reach::search(size_t u, size_t v, Scratch& scratch) const {
+    auto& [visited, stack, stamp] = scratch;
+    if (visited.empty()) visited.assign(num_sccs(), 0);
+    ++stamp;
+    stack.assign(1, u);
+    while (!stack.empty()) {
+        auto c = stack.back();
+        stack.pop_back();
+        for (auto d : cond_.succs(c)) {
+            if (d == v) return true;
+            if (d < v || visited[d] == stamp || !contains(d, v)) continue;
+            visited[d] = stamp;
+            stack.emplace_back(d);
+        }
+    }
+    return false;
+}
+
+/*
+ * queries
+ */
+
+bool Reach::reaches(const Node* a, const Node* b) const {
+    Scratch scratch;
+    return reaches(scc(a), scc(b), scratch);
+}
+
+std::vector<bool> Reach::reaches(std::span<const Query> queries) const {
+    Scratch scratch;
+    std::vector<bool> res;
+    res.reserve(queries.size());
+    for (auto [a, b] : queries) res.emplace_back(reaches(scc(a), scc(b), scratch));
+    return res;
+}
+
+bool Reach::reaches(size_t u, size_t v, Scratch& scratch) const {
+    if (u == v) return true;
+    if (u < v) return false; // edges only go from later to earlier SCCs
+    if (has_closure()) return closure_[u * words_ + v / 64] >> v % 64 & 1;
+    if (!contains(u, v)) return false;
+    if (tree_[u].lo <= tree_[v].lo && tree_[v].hi <= tree_[u].hi) return true; // v descends from u in the forest
+    return search(u, v, scratch);
+}
+
+} // namespace graphtool
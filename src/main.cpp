@@ -1,13 +1,125 @@
 #include <cstring>
 
+#include <array>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <random>
+#include <span>
 #include <stdexcept>
 
 #include "graphtool/parser.h"
+#include "graphtool/reach.h"
 
 using namespace std::literals;
 
+namespace {
+
+using Node = graphtool::Graph::Node;
+
+/// Naive reachability query for comparison.
+bool bfs(Node* a, Node* b) {
+    std::unordered_set<Node*> done{a};
+    std::vector<Node*> queue{a};
+    for (size_t i = 0; i != queue.size(); ++i) {
+        if (queue[i] == b) return true;
+        for (auto succ : graphtool::BiGraph<0>::succs(queue[i])) {
+            if (done.emplace(succ).second) queue.emplace_back(succ);
+        }
+    }
+    return false;
+}
+
+/// Time random reachability queries via graphtool::Reach against bfs.
+/// The index is built once as usual and once with GRAIL labels only.
+void bench_reach(const graphtool::Graph& graph, size_t num_queries) {
+    using Clock = std::chrono::steady_clock;
+    auto ms     = [](auto d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    auto n = graph.num_nodes();
+    if (n == 0) return;
+
+    std::mt19937_64 rng(0);
+    std::vector<graphtool::Reach::Query> queries;
+    for (size_t i = 0; i != num_queries; ++i) queries.emplace_back(graph.node(rng() % n), graph.node(rng() % n));
+
+    auto t0 = Clock::now();
+    std::vector<bool> ref;
+    for (auto [a, b] : queries) ref.emplace_back(bfs(a, b));
+    auto t1 = Clock::now();
+
+    std::cout << std::format("reach: {} nodes, {} queries\n", n, num_queries);
+    std::cout << std::format("  bfs: {:.3f} ms queries\n", ms(t1 - t0));
+    for (auto threshold : {graphtool::Reach::Closure_Threshold, size_t(0)}) {
+        auto t0    = Clock::now();
+        auto reach = graphtool::Reach(graph, threshold);
+        auto t1    = Clock::now();
+        auto res   = reach.reaches(queries);
+        auto t2    = Clock::now();
+        auto kind  = reach.has_closure() ? "closure" : "GRAIL";
+        for (size_t i = 0; i != num_queries; ++i) {
+            if (res[i] != ref[i]) throw std::logic_error(std::format("{} index is wrong for query {}", kind, i));
+        }
+        std::cout << std::format("  {}: {:.3f} ms build + {:.3f} ms queries ({} SCCs)\n", kind, ms(t1 - t0),
+                                 ms(t2 - t1), reach.num_sccs());
+    }
+}
+
+/// Time dominance analyses with each graphtool::Engine and report the fastest of several rounds.
+/// Besides @p graph itself, each engine runs on batches of distinct random graphs up to BiGraph::Max_Bits nodes.
+void bench_dom(graphtool::Graph& graph, size_t num_runs) {
+    using Clock = std::chrono::steady_clock;
+    using graphtool::Engine;
+    auto ms = [](auto d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    static constexpr size_t Num_Rounds = 5;
+    static constexpr std::array engines = {std::pair{Engine::Generic, "generic"}, std::pair{Engine::Bits, "bits"},
+                                           std::pair{Engine::Auto, "auto"}};
+    auto run = [&](std::span<graphtool::Graph> batch, size_t reps) {
+        for (auto& g : batch) graphtool::BiGraph<0>(g, Engine::Generic); // warm up so the first engine isn't penalized
+        for (auto [engine, name] : engines) {
+            auto best = Clock::duration::max();
+            for (size_t r = 0; r != Num_Rounds; ++r) {
+                auto t0 = Clock::now();
+                for (size_t i = 0; i != reps; ++i) {
+                    for (auto& g : batch) {
+                        graphtool::BiGraph<0> fw(g, engine);
+                        graphtool::BiGraph<1> bw(g, engine);
+                    }
+                }
+                best = std::min(best, Clock::now() - t0);
+            }
+            std::cout << std::format("  {:8} {:.3f} ms\n", name, ms(best));
+        }
+    };
+
+    std::cout << std::format("dom: {} nodes, {} runs\n", graph.num_nodes(), num_runs);
+    run({&graph, 1}, num_runs);
+
+    // a backbone through all nodes keeps them reachable from entry and able to reach exit
+    static constexpr size_t Num_Graphs = 1'000;
+    auto& driver = graph.driver();
+    std::mt19937_64 rng(0);
+    for (size_t size : {16, 32, 48, 64, 96, 128, 256}) {
+        std::vector<graphtool::Graph> batch;
+        batch.reserve(Num_Graphs);
+        for (size_t i = 0; i != Num_Graphs; ++i) {
+            auto& g = batch.emplace_back(driver);
+            std::vector<Node*> nodes;
+            for (size_t j = 0; j != size; ++j) nodes.emplace_back(g.node(driver.sym(std::format("n{}", j))));
+            for (size_t j = 0; j + 1 < size; ++j) {
+                g.edge(nodes[j], nodes[j + 1]);
+                if (rng() % 3 == 0) g.edge(nodes[j], nodes[rng() % size]);
+            }
+            g.finalize();
+        }
+        std::cout << std::format("dom: {} random graphs with {} nodes\n", Num_Graphs, size);
+        run(batch, 1);
+    }
+}
+
+} // namespace
+
 int main(int argc, char** argv) {
     try {
         static const auto version = "graphtool 0.1\n";
@@ -20,9 +132,13 @@ int main(int argc, char** argv) {
                                     "  -?, -h, --help\n"
                                     "  -v, --version           Display version info and exit.\n"
                                     "  -c, --crit              Eliminate critical edges.\n"
+                                    "  -b, --bench             Benchmark reachability queries and dominance engines.\n"
+                                    "  -V, --verify            Certify the (post)dominator trees.\n"
                                     "  <file>                  Input file.\n";
         std::string input;
-        bool crit = false;
+        bool crit   = false;
+        bool bench  = false;
+        bool verify = false;
 
         for (int i = 1; i < argc; ++i) {
             if (argv[i] == "-v"s || argv[i] == "--version"s) {
@@ -33,6 +149,10 @@ int main(int argc, char** argv) {
                 return EXIT_SUCCESS;
             } else if (argv[i] == "-c"s || argv[i] == "--crit"s) {
                 crit = true;
+            } else if (argv[i] == "-b"s || argv[i] == "--bench"s) {
+                bench = true;
+            } else if (argv[i] == "-V"s || argv[i] == "--verify"s) {
+                verify = true;
             } else {
                 if (!input.empty()) throw std::invalid_argument("more than one input file given");
                 input = argv[i];
@@ -54,8 +174,19 @@ int main(int argc, char** argv) {
         }
 
         if (crit) graph.critical_edge_elimination();
+        auto sccs = graphtool::Condensation(graph);
+        if (auto num = sccs.num_unreachable()) std::cerr << "warning: " << num << " node(s) unreachable from entry\n";
+        if (auto num = sccs.num_non_exiting()) std::cerr << "warning: " << num << " node(s) can't reach exit\n";
+        if (bench) {
+            bench_reach(graph, 100'000);
+            bench_dom(graph, 200);
+        }
         graphtool::BiGraph<0> fw(graph);
         graphtool::BiGraph<1> bw(graph);
+        if (verify) {
+            fw.verify();
+            bw.verify();
+        }
 
         std::ofstream forward(input + ".forward.dot");
         std::ofstream backward(input + ".backward.dot");
@@ -63,12 +194,14 @@ int main(int argc, char** argv) {
         std::ofstream postdom(input + ".postdom_tree.dot");
         std::ofstream dom_frontiers(input + ".dom_frontiers.dot");
         std::ofstream postdom_frontiers(input + ".postdom_frontiers.dot");
+        std::ofstream condensation(input + ".sccs.dot");
         fw.dump_cfg(forward);
         bw.dump_cfg(backward);
         fw.dump_dom_tree(dom);
         bw.dump_dom_tree(postdom);
         fw.dump_dom_frontiers(dom_frontiers);
         bw.dump_dom_frontiers(postdom_frontiers);
+        sccs.dump(condensation);
     } catch (const std::exception& e) {
         std::cerr << "error: " << e.what() << std::endl;
         return EXIT_FAILURE;